@@ -0,0 +1,476 @@
+#include "junctionGraph.h"
+#include <vector>
+#include <utility>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace {
+    const int dx[4] = { 0, 1, 0, -1 };
+    const int dy[4] = { -1, 0, 1, 0 };
+}
+
+JunctionGraph::JunctionGraph(const Maze& maze)
+    : width(maze.getWidth()), height(maze.getHeight()), version(maze.getVersion()),
+    changeCount(maze.getChangeCount()), nodeCount(0), edgeCount(0), liveInteriorCells(0) {
+    build(maze);
+}
+
+void JunctionGraph::checkMaze(const Maze& maze) const {
+    if (maze.getWidth() != width || maze.getHeight() != height || maze.getVersion() != version) {
+        throw std::runtime_error("JunctionGraph: Maze has changed since the graph was last updated");
+    }
+}
+
+int JunctionGraph::openNeighbours(const std::vector<std::vector<int>>& grid, int cell, int out[4]) const {
+    int x = cell % width;
+    int y = cell / width;
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        int nx = x + dx[i];
+        int ny = y + dy[i];
+        if (nx >= 0 && nx < width && ny >= 0 && ny < height && grid[ny][nx] == 1) {
+            out[count++] = ny * width + nx;
+        }
+    }
+    return count;
+}
+
+int JunctionGraph::addNode(int cell) {
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        node = static_cast<int>(nodeCell.size());
+        nodeCell.push_back(-1);
+        nodeCorridors.emplace_back();
+    }
+    nodeCell[node] = cell;
+    cellNode[cell] = node;
+    nodeCorridors[node].clear();
+    dirtyNodes.push_back(node);
+    nodeCount++;
+    return node;
+}
+
+// Callers drop the node's corridors first
+void JunctionGraph::removeNode(int node) {
+    cellNode[nodeCell[node]] = -1;
+    nodeCell[node] = -1;
+    freeNodes.push_back(node);
+    dirtyNodes.push_back(node);
+    nodeCount--;
+}
+
+int JunctionGraph::addCorridor(int from, int to, const std::vector<int>& interior) {
+    int id;
+    if (!freeCorridors.empty()) {
+        id = freeCorridors.back();
+        freeCorridors.pop_back();
+    }
+    else {
+        id = static_cast<int>(corridors.size());
+        corridors.emplace_back();
+    }
+
+    Corridor& corridor = corridors[id];
+    corridor.from = from;
+    corridor.to = to;
+    corridor.first = static_cast<int>(cellPool.size());
+    corridor.count = static_cast<int>(interior.size());
+    corridor.alive = true;
+
+    for (int i = 0; i < corridor.count; i++) {
+        cellPool.push_back(interior[i]);
+        cellCorridor[interior[i]] = id;
+        cellPosition[interior[i]] = i;
+    }
+
+    nodeCorridors[from].push_back(id);
+    if (to != from) nodeCorridors[to].push_back(id);
+    dirtyNodes.push_back(from);
+    dirtyNodes.push_back(to);
+    edgeCount++;
+    liveInteriorCells += corridor.count;
+    return id;
+}
+
+void JunctionGraph::removeCorridor(int id, std::vector<int>& freedCells, std::vector<int>& endNodes) {
+    Corridor& corridor = corridors[id];
+    if (!corridor.alive) return;
+    corridor.alive = false;
+
+    for (int i = 0; i < corridor.count; i++) {
+        int cell = cellPool[corridor.first + i];
+        cellCorridor[cell] = -1;
+        cellPosition[cell] = -1;
+        freedCells.push_back(cell);
+    }
+
+    for (int node : { corridor.from, corridor.to }) {
+        auto& list = nodeCorridors[node];
+        list.erase(std::remove(list.begin(), list.end(), id), list.end());
+        endNodes.push_back(node);
+        dirtyNodes.push_back(node);
+    }
+
+    freeCorridors.push_back(id);
+    edgeCount--;
+    liveInteriorCells -= corridor.count;
+}
+
+// Is the corridor leaving this node through the given neighbour already traced?
+bool JunctionGraph::hasCorridorTowards(int node, int cell) const {
+    for (int id : nodeCorridors[node]) {
+        const Corridor& corridor = corridors[id];
+        int fromSide = corridor.count > 0 ? cellPool[corridor.first] : nodeCell[corridor.to];
+        int toSide = corridor.count > 0 ? cellPool[corridor.first + corridor.count - 1] : nodeCell[corridor.from];
+        if ((corridor.from == node && fromSide == cell) || (corridor.to == node && toSide == cell)) return true;
+    }
+    return false;
+}
+
+// Follow every untraced exit of a node until the next node
+void JunctionGraph::traceFrom(const std::vector<std::vector<int>>& grid, int node) {
+    int start = nodeCell[node];
+    int exits[4];
+    int exitCount = openNeighbours(grid, start, exits);
+
+    for (int i = 0; i < exitCount; i++) {
+        if (hasCorridorTowards(node, exits[i])) continue;
+
+        std::vector<int> interior;
+        int previous = start;
+        int current = exits[i];
+        while (cellNode[current] == -1) {
+            interior.push_back(current);
+            // Cells that are not nodes always have exactly two open neighbours
+            int around[4];
+            if (openNeighbours(grid, current, around) != 2) {
+                throw std::runtime_error("JunctionGraph: Corridor cell does not have two open neighbours");
+            }
+            int next = (around[0] == previous) ? around[1] : around[0];
+            previous = current;
+            current = next;
+        }
+        addCorridor(node, cellNode[current], interior);
+    }
+}
+
+// Loops made only of corridor cells have no node to start from, so pin one
+void JunctionGraph::coverLeftovers(const std::vector<std::vector<int>>& grid, const std::vector<int>& cells) {
+    for (int cell : cells) {
+        if (grid[cell / width][cell % width] != 1) continue;
+        if (cellNode[cell] != -1 || cellCorridor[cell] != -1) continue;
+        traceFrom(grid, addNode(cell));
+    }
+}
+
+void JunctionGraph::build(const Maze& maze) {
+    const auto& grid = maze.getGrid();
+    int cells = width * height;
+    cellNode.assign(cells, -1);
+    cellCorridor.assign(cells, -1);
+    cellPosition.assign(cells, -1);
+    nodeCell.clear();
+    nodeCorridors.clear();
+    freeNodes.clear();
+    corridors.clear();
+    freeCorridors.clear();
+    cellPool.clear();
+    dirtyNodes.clear();
+    arcCount.clear();
+    nodeCount = edgeCount = liveInteriorCells = 0;
+    version = maze.getVersion();
+    changeCount = maze.getChangeCount();
+
+    std::vector<int> openCells;
+    int around[4];
+    for (int cell = 0; cell < cells; cell++) {
+        if (grid[cell / width][cell % width] != 1) continue;
+        openCells.push_back(cell);
+        if (openNeighbours(grid, cell, around) != 2) addNode(cell);
+    }
+
+    for (int node = 0; node < static_cast<int>(nodeCell.size()); node++) {
+        traceFrom(grid, node);
+    }
+    coverLeftovers(grid, openCells);
+    patchArcs();
+}
+
+void JunctionGraph::updateCell(const Maze& maze, int x, int y) {
+    if (!maze.isValid(x, y)) {
+        throw std::invalid_argument("JunctionGraph: Cell coordinates are outside maze boundaries");
+    }
+    if (maze.getWidth() != width || maze.getHeight() != height) {
+        throw std::invalid_argument("JunctionGraph: Maze size does not match the graph");
+    }
+
+    const auto& grid = maze.getGrid();
+    if (maze.getVersion() == version) return;
+
+    // Patching is only valid for exactly one change, at this cell, since the
+    // last sync; anything else (missed updates, a regenerated or different
+    // maze) gets a full rebuild instead
+    int changed = y * width + x;
+    bool wasOpen = cellNode[changed] != -1 || cellCorridor[changed] != -1;
+    bool isOpen = grid[y][x] == 1;
+    if (maze.getChangeCount() != changeCount + 1 || maze.getLastChange() != std::make_pair(x, y) || wasOpen == isOpen) {
+        build(maze);
+        return;
+    }
+
+    // Only the cell itself and its neighbours can change degree
+    std::vector<int> touched = { y * width + x };
+    for (int i = 0; i < 4; i++) {
+        if (maze.isValid(x + dx[i], y + dy[i])) touched.push_back((y + dy[i]) * width + x + dx[i]);
+    }
+
+    // Drop every corridor that runs through or ends at a touched cell
+    std::vector<int> freedCells;
+    std::vector<int> endNodes;
+    for (int cell : touched) {
+        if (cellCorridor[cell] != -1) removeCorridor(cellCorridor[cell], freedCells, endNodes);
+        if (cellNode[cell] != -1) {
+            std::vector<int> incident = nodeCorridors[cellNode[cell]];
+            for (int id : incident) removeCorridor(id, freedCells, endNodes);
+        }
+    }
+
+    // Decide again which touched cells are junctions or dead ends
+    int around[4];
+    for (int cell : touched) {
+        bool open = grid[cell / width][cell % width] == 1;
+        bool wanted = open && openNeighbours(grid, cell, around) != 2;
+        if (cellNode[cell] != -1 && !wanted) removeNode(cellNode[cell]);
+        else if (cellNode[cell] == -1 && wanted) addNode(cell);
+
+        if (cellNode[cell] != -1) endNodes.push_back(cellNode[cell]);
+        freedCells.push_back(cell);
+    }
+
+    // Retrace from every surviving node that lost a corridor or just appeared
+    for (int node : endNodes) {
+        if (nodeCell[node] != -1) traceFrom(grid, node);
+    }
+    coverLeftovers(grid, freedCells);
+
+    version = maze.getVersion();
+    changeCount = maze.getChangeCount();
+    patchArcs();
+}
+
+void JunctionGraph::patchArcs() {
+    // Repack corridor cells once removed corridors leave too much garbage
+    // behind; this walks every corridor, but only after as many cells have
+    // been freed as are still live
+    if (cellPool.size() > 2 * static_cast<size_t>(liveInteriorCells) + 1024) {
+        std::vector<int> packed;
+        packed.reserve(liveInteriorCells);
+        for (auto& corridor : corridors) {
+            if (!corridor.alive) continue;
+            int first = static_cast<int>(packed.size());
+            packed.insert(packed.end(), cellPool.begin() + corridor.first,
+                cellPool.begin() + corridor.first + corridor.count);
+            corridor.first = first;
+        }
+        cellPool.swap(packed);
+    }
+
+    int slots = static_cast<int>(nodeCell.size());
+    arcCount.resize(slots, 0);
+    arcTarget.resize(static_cast<size_t>(slots) * maxArcs);
+    arcLength.resize(static_cast<size_t>(slots) * maxArcs);
+    arcCorridor.resize(static_cast<size_t>(slots) * maxArcs);
+
+    // Rewrite the arc block of every node whose corridors changed
+    for (int node : dirtyNodes) {
+        int count = 0;
+        if (nodeCell[node] != -1) {
+            for (int id : nodeCorridors[node]) {
+                const Corridor& corridor = corridors[id];
+                // Loops back to the same node never shorten a route
+                if (corridor.from == corridor.to) continue;
+
+                int arc = node * maxArcs + count++;
+                bool forward = corridor.from == node;
+                arcTarget[arc] = forward ? corridor.to : corridor.from;
+                arcLength[arc] = corridor.count + 1;
+                arcCorridor[arc] = forward ? id : ~id;
+            }
+        }
+        arcCount[node] = count;
+    }
+    dirtyNodes.clear();
+}
+
+// A node leaves through itself; a corridor cell through both ends of its corridor
+void JunctionGraph::locate(int cell, std::vector<std::pair<int, int>>& exits) const {
+    exits.clear();
+    if (cellNode[cell] != -1) {
+        exits.push_back({ cellNode[cell], 0 });
+    }
+    else if (cellCorridor[cell] != -1) {
+        const Corridor& corridor = corridors[cellCorridor[cell]];
+        int position = cellPosition[cell];
+        exits.push_back({ corridor.from, position + 1 });
+        exits.push_back({ corridor.to, corridor.count - position });
+    }
+}
+
+// Interior cells of a corridor followed by the node it leads to
+void JunctionGraph::appendCorridor(int corridorId, bool forward, std::vector<int>& cells) const {
+    const Corridor& corridor = corridors[corridorId];
+    if (forward) {
+        for (int i = 0; i < corridor.count; i++) cells.push_back(cellPool[corridor.first + i]);
+        cells.push_back(nodeCell[corridor.to]);
+    }
+    else {
+        for (int i = corridor.count - 1; i >= 0; i--) cells.push_back(cellPool[corridor.first + i]);
+        cells.push_back(nodeCell[corridor.from]);
+    }
+}
+
+std::vector<std::pair<int, int>> JunctionGraph::solve(const Maze& maze,
+    int startX, int startY, int endX, int endY, int* expandedCount) const {
+
+    if (!maze.isValid(startX, startY) || !maze.isValid(endX, endY)) {
+        throw std::invalid_argument("JunctionGraph: Start or end coordinates are outside maze boundaries");
+    }
+    checkMaze(maze);
+    if (expandedCount) *expandedCount = 0;
+
+    int startCell = startY * width + startX;
+    int endCell = endY * width + endX;
+
+    std::vector<std::pair<int, int>> starts, ends;
+    locate(startCell, starts);
+    locate(endCell, ends);
+    if (starts.empty() || ends.empty()) return {};
+    if (startCell == endCell) return { { startX, startY } };
+
+    // Both ends inside one corridor can also be joined without leaving it
+    int best = INT_MAX;
+    int bestNode = -1, bestExit = -1;
+    bool sameCorridor = cellCorridor[startCell] != -1 && cellCorridor[startCell] == cellCorridor[endCell];
+    if (sameCorridor) best = std::abs(cellPosition[startCell] - cellPosition[endCell]);
+
+    int slots = static_cast<int>(nodeCell.size());
+    std::vector<int> distance(slots, INT_MAX);
+    std::vector<int> parentArc(slots, -1);
+    std::vector<int> parentNode(slots, -1);
+    std::vector<int> startExit(slots, -1);
+
+    using Node = std::pair<int, int>; // distance, node id
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> minHeap;
+    for (int i = 0; i < static_cast<int>(starts.size()); i++) {
+        int node = starts[i].first;
+        if (starts[i].second < distance[node]) {
+            distance[node] = starts[i].second;
+            startExit[node] = i;
+            minHeap.push({ starts[i].second, node });
+        }
+    }
+
+    int expanded = 0;
+    while (!minHeap.empty()) {
+        Node current = minHeap.top();
+        minHeap.pop();
+        int d = current.first;
+        int node = current.second;
+
+        if (d != distance[node]) continue;
+        // Nothing left in the heap can beat the route we already have
+        if (d >= best) break;
+        expanded++;
+
+        for (int i = 0; i < static_cast<int>(ends.size()); i++) {
+            if (ends[i].first == node && d + ends[i].second < best) {
+                best = d + ends[i].second;
+                bestNode = node;
+                bestExit = i;
+            }
+        }
+
+        for (int arc = node * maxArcs; arc < node * maxArcs + arcCount[node]; arc++) {
+            int next = arcTarget[arc];
+            int newDist = d + arcLength[arc];
+            if (newDist < distance[next]) {
+                distance[next] = newDist;
+                parentArc[next] = arc;
+                parentNode[next] = node;
+                startExit[next] = -1;
+                minHeap.push({ newDist, next });
+            }
+        }
+    }
+    if (expandedCount) *expandedCount = expanded;
+
+    if (best == INT_MAX) return {};
+
+    std::vector<int> cells;
+    if (bestNode == -1) {
+        // Straight along the shared corridor
+        const Corridor& corridor = corridors[cellCorridor[startCell]];
+        int from = cellPosition[startCell];
+        int to = cellPosition[endCell];
+        int stepDir = (to >= from) ? 1 : -1;
+        for (int i = from; i != to + stepDir; i += stepDir) cells.push_back(cellPool[corridor.first + i]);
+    }
+    else {
+        std::vector<int> arcs;
+        int node = bestNode;
+        while (parentArc[node] != -1) {
+            arcs.push_back(parentArc[node]);
+            node = parentNode[node];
+        }
+        std::reverse(arcs.begin(), arcs.end());
+
+        // From the start cell out to the first node
+        cells.push_back(startCell);
+        if (cellNode[startCell] == -1) {
+            const Corridor& corridor = corridors[cellCorridor[startCell]];
+            int position = cellPosition[startCell];
+            if (startExit[node] == 0) {
+                for (int i = position - 1; i >= 0; i--) cells.push_back(cellPool[corridor.first + i]);
+                cells.push_back(nodeCell[corridor.from]);
+            }
+            else {
+                for (int i = position + 1; i < corridor.count; i++) cells.push_back(cellPool[corridor.first + i]);
+                cells.push_back(nodeCell[corridor.to]);
+            }
+        }
+
+        for (int arc : arcs) {
+            int id = arcCorridor[arc];
+            appendCorridor(id >= 0 ? id : ~id, id >= 0, cells);
+        }
+
+        // From the last node in to the end cell
+        if (cellNode[endCell] == -1) {
+            const Corridor& corridor = corridors[cellCorridor[endCell]];
+            int position = cellPosition[endCell];
+            if (bestExit == 0) {
+                for (int i = 0; i <= position; i++) cells.push_back(cellPool[corridor.first + i]);
+            }
+            else {
+                for (int i = corridor.count - 1; i >= position; i--) cells.push_back(cellPool[corridor.first + i]);
+            }
+        }
+    }
+
+    std::vector<std::pair<int, int>> path;
+    path.reserve(cells.size());
+    for (int cell : cells) path.push_back({ cell % width, cell / width });
+    return path;
+}
+
+int JunctionGraph::findDistance(const Maze& maze, int startX, int startY, int endX, int endY) const {
+    auto path = solve(maze, startX, startY, endX, endY);
+    return path.empty() ? -1 : static_cast<int>(path.size()) - 1;
+}
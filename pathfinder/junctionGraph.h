@@ -0,0 +1,83 @@
+#ifndef JUNCTION_GRAPH_H
+#define JUNCTION_GRAPH_H
+
+#include "maze.h"
+#include <vector>
+#include <utility>
+
+// Maze contracted to its junctions and dead ends.
+// Runs of degree-2 corridor cells become single weighted edges, so the
+// solver only expands cells where the route can actually branch. Each
+// edge keeps its corridor cells so paths can be expanded back to cells.
+// Call updateCell after every Maze::setCell to patch the graph in place;
+// if changes were missed, updateCell falls back to a full rebuild.
+class JunctionGraph {
+public:
+    explicit JunctionGraph(const Maze& maze);
+
+    // Re-contract the neighbourhood of a changed cell, or rebuild when out of sync
+    void updateCell(const Maze& maze, int x, int y);
+
+    // Dijkstra over the junction graph, expanded back to a cell path.
+    // Walls never connect to anything, so a start or end in a wall has no path.
+    std::vector<std::pair<int, int>> solve(const Maze& maze,
+        int startX, int startY, int endX, int endY, int* expandedCount = nullptr) const;
+    // Number of moves on the shortest path, or -1 when there is none
+    int findDistance(const Maze& maze, int startX, int startY, int endX, int endY) const;
+
+    int getNodeCount() const { return nodeCount; }
+    int getEdgeCount() const { return edgeCount; }
+
+private:
+    struct Corridor {
+        int from, to;       // node ids at both ends
+        int first, count;   // interior cells in cellPool, ordered from -> to
+        bool alive;
+    };
+
+    void build(const Maze& maze);
+    void checkMaze(const Maze& maze) const;
+
+    int openNeighbours(const std::vector<std::vector<int>>& grid, int cell, int out[4]) const;
+    int addNode(int cell);
+    void removeNode(int node);
+    int addCorridor(int from, int to, const std::vector<int>& interior);
+    void removeCorridor(int id, std::vector<int>& freedCells, std::vector<int>& endNodes);
+    bool hasCorridorTowards(int node, int cell) const;
+    void traceFrom(const std::vector<std::vector<int>>& grid, int node);
+    void coverLeftovers(const std::vector<std::vector<int>>& grid, const std::vector<int>& cells);
+    void patchArcs();
+
+    // Node ids a query cell can leave through, with the cost to reach them
+    void locate(int cell, std::vector<std::pair<int, int>>& exits) const;
+    void appendCorridor(int corridorId, bool forward, std::vector<int>& cells) const;
+
+    int width, height;
+    unsigned long long version;
+    unsigned long long changeCount;     // maze change count at the last sync
+
+    // Node and corridor slots are reused after removal, so ids stay stable
+    std::vector<int> nodeCell;           // node id -> cell, -1 for a free slot
+    std::vector<int> cellNode;           // cell -> node id or -1
+    std::vector<std::vector<int>> nodeCorridors;
+    std::vector<int> freeNodes;
+    std::vector<Corridor> corridors;
+    std::vector<int> freeCorridors;
+    std::vector<int> cellPool;
+    std::vector<int> cellCorridor;       // interior cell -> corridor id or -1
+    std::vector<int> cellPosition;       // interior cell -> index inside its corridor
+    int nodeCount, edgeCount, liveInteriorCells;
+
+    // CSR with a fixed stride: arcs of node n are [n * maxArcs, n * maxArcs + arcCount[n]).
+    // A cell has at most four exits, so a node's block is rewritten in place
+    // when its corridors change and no other node is touched.
+    // arcCorridor holds the corridor id when walked from -> to, and ~id when walked back.
+    static const int maxArcs = 4;
+    std::vector<int> dirtyNodes;
+    std::vector<int> arcCount;
+    std::vector<int> arcTarget;
+    std::vector<int> arcLength;
+    std::vector<int> arcCorridor;
+};
+
+#endif
@@ -0,0 +1,462 @@
+#include "landmarks.h"
+#include <vector>
+#include <utility>
+#include <queue>
+#include <tuple>
+#include <functional>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    const char fileMagic[4] = { 'P', 'F', 'L', 'M' };
+    const std::uint32_t fileFormatVersion = 1;
+
+    const int dx[4] = { 0, 1, 0, -1 };
+    const int dy[4] = { -1, 0, 1, 0 };
+
+    // Plain BFS distance field from one cell, -1 where it cannot reach
+    void fillDistanceField(const std::vector<std::vector<int>>& grid, int width, int height,
+        int source, std::vector<int>& field) {
+
+        field.assign(width * height, -1);
+        std::queue<int> frontier;
+        field[source] = 0;
+        frontier.push(source);
+
+        while (!frontier.empty()) {
+            int cell = frontier.front();
+            frontier.pop();
+            int x = cell % width;
+            int y = cell / width;
+
+            for (int i = 0; i < 4; i++) {
+                int nx = x + dx[i];
+                int ny = y + dy[i];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height || grid[ny][nx] != 1) continue;
+
+                int next = ny * width + nx;
+                if (field[next] == -1) {
+                    field[next] = field[cell] + 1;
+                    frontier.push(next);
+                }
+            }
+        }
+    }
+
+    // Walk the border clockwise from the top-left corner
+    std::pair<int, int> borderPoint(int width, int height, int t) {
+        if (t < width) return { t, 0 };
+        t -= width - 1;
+        if (t < height) return { width - 1, t };
+        t -= height - 1;
+        if (t < width) return { width - 1 - t, height - 1 };
+        t -= width - 1;
+        return { 0, height - 1 - t };
+    }
+
+    unsigned threadCount(size_t jobs) {
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(hardware, jobs)));
+    }
+}
+
+LandmarkIndex::LandmarkIndex(const Maze& maze, int landmarkCount)
+    : width(maze.getWidth()), height(maze.getHeight()),
+    version(maze.getVersion()), gridHash(hashGrid(maze)) {
+
+    if (landmarkCount < 0) {
+        throw std::invalid_argument("LandmarkIndex: Landmark count cannot be negative");
+    }
+
+    const auto& grid = maze.getGrid();
+    std::vector<std::pair<int, int>> openCells;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (grid[y][x] == 1) openCells.push_back({ x, y });
+        }
+    }
+
+    // Landmarks work best far apart and on the edge of the maze, so take the
+    // open cell nearest to evenly spaced points along the border
+    landmarkCount = std::min(landmarkCount, static_cast<int>(openCells.size()));
+    int perimeter = std::max(1, 2 * (width + height) - 4);
+    for (int k = 0; k < landmarkCount; k++) {
+        auto target = borderPoint(width, height, static_cast<int>(static_cast<long long>(k) * perimeter / landmarkCount));
+        int bestIndex = -1, bestDistance = INT_MAX;
+
+        for (int i = 0; i < static_cast<int>(openCells.size()); i++) {
+            if (std::find(landmarks.begin(), landmarks.end(), openCells[i]) != landmarks.end()) continue;
+            int d = std::abs(openCells[i].first - target.first) + std::abs(openCells[i].second - target.second);
+            if (d < bestDistance) { bestDistance = d; bestIndex = i; }
+        }
+        landmarks.push_back(openCells[bestIndex]);
+    }
+
+    // Each landmark is an independent BFS, so spread them over threads
+    int count = static_cast<int>(landmarks.size());
+    std::vector<std::vector<int>> perLandmark(count);
+    unsigned workers = threadCount(count);
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < workers; t++) {
+        threads.emplace_back([&, t]() {
+            for (int l = static_cast<int>(t); l < count; l += static_cast<int>(workers)) {
+                int source = landmarks[l].second * width + landmarks[l].first;
+                fillDistanceField(grid, width, height, source, perLandmark[l]);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // Store cell-major so a heuristic lookup touches one small block
+    int cells = width * height;
+    fields.assign(static_cast<size_t>(cells) * count, -1);
+    for (int l = 0; l < count; l++) {
+        for (int cell = 0; cell < cells; cell++) {
+            fields[static_cast<size_t>(cell) * count + l] = perLandmark[l][cell];
+        }
+    }
+}
+
+// Single queries share one scratch space per thread instead of allocating
+// three maze-sized arrays every call; search resizes it when the maze size changes
+LandmarkIndex::Workspace& LandmarkIndex::threadWorkspace() {
+    static thread_local Workspace space;
+    return space;
+}
+
+// FNV-1a over the grid, used to tell whether a saved index still fits
+unsigned long long LandmarkIndex::hashGrid(const Maze& maze) {
+    unsigned long long hash = 1469598103934665603ULL;
+    for (const auto& row : maze.getGrid()) {
+        for (int value : row) {
+            hash ^= static_cast<unsigned long long>(value);
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+void LandmarkIndex::checkMaze(const Maze& maze) const {
+    if (maze.getWidth() != width || maze.getHeight() != height || maze.getVersion() != version) {
+        throw std::runtime_error("LandmarkIndex: Maze has changed since the index was built");
+    }
+}
+
+int LandmarkIndex::lowerBound(int fromCell, int toCell) const {
+    int bound = std::abs(fromCell % width - toCell % width) + std::abs(fromCell / width - toCell / width);
+    int count = static_cast<int>(landmarks.size());
+    const int* from = fields.data() + static_cast<size_t>(fromCell) * count;
+    const int* to = fields.data() + static_cast<size_t>(toCell) * count;
+
+    // Triangle inequality: d(from, to) >= |d(L, to) - d(L, from)|
+    for (int l = 0; l < count; l++) {
+        if (from[l] >= 0 && to[l] >= 0) bound = std::max(bound, std::abs(to[l] - from[l]));
+    }
+    return bound;
+}
+
+// A* guided by the landmark bounds, returns the distance or -1
+int LandmarkIndex::search(const Maze& maze, Workspace& space,
+    int startCell, int endCell, int* expandedCount) const {
+
+    const auto& grid = maze.getGrid();
+    int cells = width * height;
+    int count = static_cast<int>(landmarks.size());
+    int expanded = 0;
+    if (expandedCount) *expandedCount = 0;
+
+    // Landmarks see the maze's components: if one reaches only one of the
+    // two open cells, they cannot be connected
+    bool startOpen = grid[startCell / width][startCell % width] == 1;
+    bool endOpen = grid[endCell / width][endCell % width] == 1;
+    if (startOpen && endOpen) {
+        for (int l = 0; l < count; l++) {
+            bool reachesStart = fields[static_cast<size_t>(startCell) * count + l] >= 0;
+            bool reachesEnd = fields[static_cast<size_t>(endCell) * count + l] >= 0;
+            if (reachesStart != reachesEnd) return -1;
+        }
+    }
+
+    if (static_cast<int>(space.stamp.size()) != cells) {
+        space.distance.assign(cells, INT_MAX);
+        space.parent.assign(cells, -1);
+        space.stamp.assign(cells, 0);
+        space.generation = 0;
+    }
+    if (++space.generation == INT_MAX) {
+        std::fill(space.stamp.begin(), space.stamp.end(), 0);
+        space.generation = 1;
+    }
+    auto touch = [&](int cell) {
+        if (space.stamp[cell] != space.generation) {
+            space.stamp[cell] = space.generation;
+            space.distance[cell] = INT_MAX;
+            space.parent[cell] = -1;
+        }
+    };
+
+    // f, -g (prefer deeper nodes on ties), cell
+    using Node = std::tuple<int, int, int>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+
+    touch(startCell);
+    space.distance[startCell] = 0;
+    open.push(std::make_tuple(lowerBound(startCell, endCell), 0, startCell));
+
+    while (!open.empty()) {
+        Node current = open.top();
+        open.pop();
+        int g = -std::get<1>(current);
+        int cell = std::get<2>(current);
+
+        // Skip entries left behind by a shorter route
+        if (g != space.distance[cell]) continue;
+        expanded++;
+
+        if (cell == endCell) {
+            if (expandedCount) *expandedCount = expanded;
+            return g;
+        }
+
+        int x = cell % width;
+        int y = cell / width;
+        for (int i = 0; i < 4; i++) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height || grid[ny][nx] != 1) continue;
+
+            int next = ny * width + nx;
+            touch(next);
+            if (g + 1 < space.distance[next]) {
+                space.distance[next] = g + 1;
+                space.parent[next] = cell;
+                open.push(std::make_tuple(g + 1 + lowerBound(next, endCell), -(g + 1), next));
+            }
+        }
+    }
+
+    if (expandedCount) *expandedCount = expanded;
+    return -1;
+}
+
+std::vector<std::pair<int, int>> LandmarkIndex::solveAStar(const Maze& maze,
+    int startX, int startY, int endX, int endY, int* expandedCount) const {
+
+    if (!maze.isValid(startX, startY) || !maze.isValid(endX, endY)) {
+        throw std::invalid_argument("ALT: Start or end coordinates are outside maze boundaries");
+    }
+    checkMaze(maze);
+
+    Workspace& space = threadWorkspace();
+    int startCell = startY * width + startX;
+    int endCell = endY * width + endX;
+    if (search(maze, space, startCell, endCell, expandedCount) < 0) return {};
+
+    // Walk back from the end along parent links
+    std::vector<std::pair<int, int>> path;
+    for (int cell = endCell; cell != -1; cell = space.parent[cell]) {
+        path.push_back({ cell % width, cell / width });
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+int LandmarkIndex::findDistance(const Maze& maze, int startX, int startY, int endX, int endY) const {
+    if (!maze.isValid(startX, startY) || !maze.isValid(endX, endY)) {
+        throw std::invalid_argument("ALT: Start or end coordinates are outside maze boundaries");
+    }
+    checkMaze(maze);
+
+    return search(maze, threadWorkspace(), startY * width + startX, endY * width + endX, nullptr);
+}
+
+std::vector<std::vector<int>> LandmarkIndex::distanceMatrix(const Maze& maze,
+    const std::vector<std::pair<int, int>>& points) const {
+
+    checkMaze(maze);
+    for (const auto& point : points) {
+        if (!maze.isValid(point.first, point.second)) {
+            throw std::invalid_argument("ALT: Matrix point is outside maze boundaries");
+        }
+        // A search can leave a wall but never enter one, so distances to and
+        // from a wall differ and the matrix could not be mirrored
+        if (maze.getGrid()[point.second][point.first] != 1) {
+            throw std::invalid_argument("ALT: Matrix point is a wall");
+        }
+    }
+
+    int n = static_cast<int>(points.size());
+    std::vector<std::vector<int>> matrix(n, std::vector<int>(n, 0));
+    unsigned workers = threadCount(n);
+    std::vector<std::thread> threads;
+
+    // Each thread owns whole rows and fills the upper triangle plus its mirror,
+    // so no two threads ever write the same element
+    for (unsigned t = 0; t < workers; t++) {
+        threads.emplace_back([&, t]() {
+            Workspace space;
+            for (int i = static_cast<int>(t); i < n; i += static_cast<int>(workers)) {
+                int from = points[i].second * width + points[i].first;
+                for (int j = i + 1; j < n; j++) {
+                    int to = points[j].second * width + points[j].first;
+                    int d = search(maze, space, from, to, nullptr);
+                    matrix[i][j] = d;
+                    matrix[j][i] = d;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    return matrix;
+}
+
+void LandmarkIndex::save(const std::string& fileName) const {
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create landmark index file");
+    }
+
+    std::int32_t header[3] = { width, height, static_cast<std::int32_t>(landmarks.size()) };
+    std::uint64_t hash = gridHash;
+    file.write(fileMagic, sizeof(fileMagic));
+    file.write(reinterpret_cast<const char*>(&fileFormatVersion), sizeof(fileFormatVersion));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+
+    for (const auto& landmark : landmarks) {
+        std::int32_t cell[2] = { landmark.first, landmark.second };
+        file.write(reinterpret_cast<const char*>(cell), sizeof(cell));
+    }
+    for (int value : fields) {
+        std::int32_t stored = value;
+        file.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed to write landmark index file");
+    }
+}
+
+LandmarkIndex LandmarkIndex::load(const std::string& fileName, const Maze& maze) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open landmark index file");
+    }
+
+    char magic[4];
+    std::uint32_t formatVersion = 0;
+    std::int32_t header[3] = { 0, 0, 0 };
+    std::uint64_t hash = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&formatVersion), sizeof(formatVersion));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+
+    if (!file || !std::equal(magic, magic + 4, fileMagic) || formatVersion != fileFormatVersion) {
+        throw std::runtime_error("Landmark index file is not in a supported format");
+    }
+    if (header[0] != maze.getWidth() || header[1] != maze.getHeight() || hash != hashGrid(maze)) {
+        throw std::runtime_error("Landmark index file was built for a different maze");
+    }
+    // Everything below feeds the heuristic, so a bad value would make A*
+    // return wrong distances rather than fail
+    int cells = maze.getWidth() * maze.getHeight();
+    if (header[2] < 0 || header[2] > cells) {
+        throw std::runtime_error("Landmark index file is corrupted");
+    }
+
+    // Make sure the file really holds what the header promises before allocating for it
+    std::streamoff headerSize = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(headerSize);
+    std::streamoff expectedSize = headerSize
+        + static_cast<std::streamoff>(header[2]) * 2 * sizeof(std::int32_t)
+        + static_cast<std::streamoff>(cells) * header[2] * sizeof(std::int32_t);
+    if (fileSize < expectedSize) {
+        throw std::runtime_error("Landmark index file is truncated");
+    }
+    if (fileSize > expectedSize) {
+        throw std::runtime_error("Landmark index file is corrupted");
+    }
+
+    LandmarkIndex index;
+    index.width = header[0];
+    index.height = header[1];
+    index.version = maze.getVersion();
+    index.gridHash = hash;
+
+    const auto& grid = maze.getGrid();
+    for (int l = 0; l < header[2]; l++) {
+        std::int32_t cell[2] = { 0, 0 };
+        file.read(reinterpret_cast<char*>(cell), sizeof(cell));
+        if (!maze.isValid(cell[0], cell[1]) || grid[cell[1]][cell[0]] != 1) {
+            throw std::runtime_error("Landmark index file is corrupted");
+        }
+        index.landmarks.push_back({ cell[0], cell[1] });
+    }
+
+    index.fields.resize(static_cast<size_t>(cells) * header[2]);
+    for (auto& value : index.fields) {
+        std::int32_t stored = 0;
+        file.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+        value = stored;
+    }
+
+    if (!file) {
+        throw std::runtime_error("Landmark index file is truncated");
+    }
+    if (!index.fieldsMatchGrid(maze)) {
+        throw std::runtime_error("Landmark index file is corrupted");
+    }
+    return index;
+}
+
+// A field is safe to use when it is 0 at its landmark, -1 on walls, and
+// changes by at most one between open neighbours without switching between
+// reachable and unreachable. That makes |d(L, a) - d(L, b)| a true lower
+// bound and keeps the "different components" shortcut honest.
+bool LandmarkIndex::fieldsMatchGrid(const Maze& maze) const {
+    const auto& grid = maze.getGrid();
+    int cells = width * height;
+    int count = static_cast<int>(landmarks.size());
+
+    for (int l = 0; l < count; l++) {
+        if (fields[static_cast<size_t>(landmarks[l].second * width + landmarks[l].first) * count + l] != 0) return false;
+    }
+
+    for (int cell = 0; cell < cells; cell++) {
+        int x = cell % width;
+        int y = cell / width;
+        const int* here = fields.data() + static_cast<size_t>(cell) * count;
+
+        if (grid[y][x] != 1) {
+            for (int l = 0; l < count; l++) {
+                if (here[l] != -1) return false;
+            }
+            continue;
+        }
+
+        // Checking right and down covers every neighbouring pair once
+        for (int i = 1; i <= 2; i++) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (nx >= width || ny >= height || grid[ny][nx] != 1) continue;
+
+            const int* next = fields.data() + static_cast<size_t>(ny * width + nx) * count;
+            for (int l = 0; l < count; l++) {
+                if (here[l] < -1 || next[l] < -1 || here[l] >= cells || next[l] >= cells) return false;
+                if ((here[l] == -1) != (next[l] == -1)) return false;
+                if (here[l] != -1 && std::abs(here[l] - next[l]) > 1) return false;
+            }
+        }
+    }
+    return true;
+}
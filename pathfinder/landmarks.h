@@ -0,0 +1,58 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "maze.h"
+#include <vector>
+#include <utility>
+#include <string>
+
+// ALT (A*, Landmarks, Triangle inequality) index for one maze.
+// Distances from a handful of landmark cells give admissible lower bounds
+// |d(L, target) - d(L, cell)|, which steer A* straight at the target.
+// The index belongs to one maze version; queries on a changed maze throw.
+class LandmarkIndex {
+public:
+    // Pick landmarks spread around the border and compute their distance fields in parallel
+    LandmarkIndex(const Maze& maze, int landmarkCount = 8);
+
+    // Read an index saved next to the maze, checking that it still matches the grid
+    static LandmarkIndex load(const std::string& fileName, const Maze& maze);
+    void save(const std::string& fileName) const;
+
+    std::vector<std::pair<int, int>> solveAStar(const Maze& maze,
+        int startX, int startY, int endX, int endY, int* expandedCount = nullptr) const;
+    // Number of moves on the shortest path, or -1 when there is none
+    int findDistance(const Maze& maze, int startX, int startY, int endX, int endY) const;
+    // Pairwise distances between open cells, rows split across threads
+    std::vector<std::vector<int>> distanceMatrix(const Maze& maze,
+        const std::vector<std::pair<int, int>>& points) const;
+
+    int lowerBound(int fromCell, int toCell) const;
+    const std::vector<std::pair<int, int>>& getLandmarks() const { return landmarks; }
+
+private:
+    // Per-thread A* scratch space, reused between queries via generation stamps
+    struct Workspace {
+        std::vector<int> distance;
+        std::vector<int> parent;
+        std::vector<int> stamp;
+        int generation = 0;
+    };
+
+    LandmarkIndex() : width(0), height(0), version(0), gridHash(0) {}
+
+    void checkMaze(const Maze& maze) const;
+    bool fieldsMatchGrid(const Maze& maze) const;
+    int search(const Maze& maze, Workspace& space, int startCell, int endCell, int* expandedCount) const;
+    static unsigned long long hashGrid(const Maze& maze);
+    static Workspace& threadWorkspace();
+
+    int width, height;
+    unsigned long long version;
+    unsigned long long gridHash;
+    std::vector<std::pair<int, int>> landmarks;
+    // Cell-major: fields[cell * landmarkCount + l], -1 where unreachable
+    std::vector<int> fields;
+};
+
+#endif
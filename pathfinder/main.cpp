@@ -8,6 +8,14 @@ int main() {
         demo::runBFSDemo();
         std::cout << "\n" << std::string(50, '=') << "\n";
         demo::runDijkstraDemo();
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        demo::runSteppedSearchDemo();
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        demo::runPathCacheDemo();
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        demo::runLandmarkDemo();
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        demo::runJunctionGraphDemo();
         return 0;
     }
     catch (const std::exception& e) {
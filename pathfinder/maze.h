@@ -9,6 +9,14 @@ private:
     int width, height;
     std::vector<std::vector<int>> grid;
     std::vector<std::vector<bool>> visited;
+    // Bumped on every change to the grid, unique across all mazes
+    unsigned long long version;
+    // Names this maze for caches that outlive it; copies share it
+    unsigned long long id;
+    // Changes made to this maze so far, and the cell the last one touched
+    // ({ -1, -1 } when the whole grid was regenerated)
+    unsigned long long changeCount;
+    std::pair<int, int> lastChange;
     // Directions: UP, RIGHT, DOWN, LEFT
     const int dx[4] = { 0, 1, 0, -1 };
     const int dy[4] = { -1, 0, 1, 0 };
@@ -17,8 +25,9 @@ public:
     Maze(int w, int h);
     // Core functionality
     void generateMaze(int startX = 1, int startY = 1);
+    void setCell(int x, int y, int value);
     // Utility methods
-    bool isValid(int x, int y);
+    bool isValid(int x, int y) const;
     void display() const;
     void resetVisited();
     // Getters
@@ -27,12 +36,20 @@ public:
     std::pair<int, int> getStart() const { return { 0, 1 }; }
     std::pair<int, int> getEnd() const { return { width - 1, height - 2 }; }
     const std::vector<std::vector<int>>& getGrid() const { return grid; }
+    unsigned long long getVersion() const { return version; }
+    unsigned long long getId() const { return id; }
+    unsigned long long getChangeCount() const { return changeCount; }
+    std::pair<int, int> getLastChange() const { return lastChange; }
     std::vector<std::vector<bool>>& getVisited() { return visited; }
 };
 
 namespace demo {
     void runBFSDemo();
     void runDijkstraDemo();
+    void runSteppedSearchDemo();
+    void runPathCacheDemo();
+    void runLandmarkDemo();
+    void runJunctionGraphDemo();
 }
 
 #endif
\ No newline at end of file
@@ -6,17 +6,31 @@
 #include <random>
 #include <algorithm>
 #include <utility>
+#include <atomic>
+#include <stdexcept>
+#include <iomanip>
 #include "bfsGraphDrawer.h"
 #include "dijkstraGraphDrawer.h"
 #include "dijkstra.h"
+#include "steppedSearch.h"
+#include "pathCache.h"
+#include "landmarks.h"
+#include "junctionGraph.h"
 
-Maze::Maze(int w, int h) : width(w), height(h) {
+// Hands out maze versions, so no two maze states ever share one
+static unsigned long long nextVersion() {
+    static std::atomic<unsigned long long> counter(0);
+    return ++counter;
+}
+
+Maze::Maze(int w, int h) : width(w), height(h), version(nextVersion()), id(version),
+    changeCount(0), lastChange(-1, -1) {
     // Start with everything as walls
     grid.resize(height, std::vector<int>(width, 0));
     visited.resize(height, std::vector<bool>(width, false));
 }
 
-bool Maze::isValid(int x, int y) {
+bool Maze::isValid(int x, int y) const {
     return x >= 0 && x < width && y >= 0 && y < height;
 }
 
@@ -69,6 +83,21 @@ void Maze::generateMaze(int startX, int startY) {
     // Create entrance and exit
     grid[1][0] = 1;
     grid[height - 2][width - 1] = 1;
+    version = nextVersion();
+    changeCount++;
+    lastChange = { -1, -1 };
+}
+
+// Open (1) or close (0) a single cell
+void Maze::setCell(int x, int y, int value) {
+    if (!isValid(x, y)) {
+        throw std::invalid_argument("Maze: Cell coordinates are outside maze boundaries");
+    }
+    if (grid[y][x] == value) return;
+    grid[y][x] = value;
+    version = nextVersion();
+    changeCount++;
+    lastChange = { x, y };
 }
 
 void Maze::display() const {
@@ -126,4 +155,130 @@ void demo::runDijkstraDemo() {
         DijkstraSolver::analyzeSolution(path);
     }
     else std::cout << "Dijkstra: No path found!\n";
+}
+
+void demo::runSteppedSearchDemo() {
+    // Spread one search over several "frames" with a fixed node budget
+    std::cout << "\nStepped search\n\n";
+    Maze maze(31, 31);
+    maze.generateMaze();
+    auto start = maze.getStart();
+    auto end = maze.getEnd();
+
+    SteppedSearch search(maze, start.first, start.second, end.first, end.second);
+    const int budgetPerFrame = 50;
+    int frame = 0;
+
+    while (!search.isDone()) {
+        search.step(budgetPerFrame);
+        frame++;
+        std::cout << "Frame " << frame << ": expanded " << search.getExpandedCount()
+            << " cells, frontier " << search.getFrontierSize()
+            << ", best partial path " << search.getBestPartialPath().size() << " steps\n";
+    }
+
+    auto path = search.getPath();
+    if (!path.empty()) {
+        BFSSolver::displaySolution(maze, path);
+        BFSSolver::analyzeSolution(path);
+    }
+    else std::cout << "Stepped search: No path found!\n";
+}
+
+void demo::runPathCacheDemo() {
+    // Ask for hot routes repeatedly and let the cache answer them
+    std::cout << "\nPath cache\n\n";
+    Maze maze(31, 31);
+    maze.generateMaze();
+    auto start = maze.getStart();
+    auto end = maze.getEnd();
+
+    PathCache cache(16);
+    auto path = cache.findPath(maze, start.first, start.second, end.first, end.second);
+    cache.findPath(maze, start.first, start.second, end.first, end.second);
+
+    // Any two cells on a cached shortest path are answered without a search
+    if (path.size() > 2) {
+        auto middle = path[path.size() / 2];
+        std::cout << "Middle to start: "
+            << cache.findDistance(maze, middle.first, middle.second, start.first, start.second)
+            << " moves\n";
+    }
+
+    // A path may start on a wall, but must never be reused to end on one
+    int fromWall = cache.findDistance(maze, 0, 0, 1, 1);
+    int toWall = cache.findDistance(maze, 1, 1, 0, 0);
+    std::cout << "Wall to (1,1): " << fromWall << " moves, (1,1) to wall: " << toWall << " moves\n";
+
+    // Changing the maze makes the old answers stale
+    maze.setCell(end.first, end.second, 0);
+    if (cache.findPath(maze, start.first, start.second, end.first, end.second).empty()) {
+        std::cout << "Exit closed: No path found!\n";
+    }
+
+    std::cout << "* Cache hits: " << cache.getHits()
+        << " (" << cache.getSubpathHits() << " from subpaths), misses: " << cache.getMisses() << "\n";
+}
+
+void demo::runLandmarkDemo() {
+    // Preprocess once, then answer many distance queries quickly
+    std::cout << "\nALT landmarks\n\n";
+    Maze maze(31, 31);
+    maze.generateMaze();
+    auto start = maze.getStart();
+    auto end = maze.getEnd();
+
+    LandmarkIndex landmarks(maze, 8);
+    int expanded = 0;
+    auto path = landmarks.solveAStar(maze, start.first, start.second, end.first, end.second, &expanded);
+
+    if (!path.empty()) {
+        std::cout << "* Total path length: " << path.size() << " steps\n";
+        std::cout << "* Cells expanded by ALT A*: " << expanded << "\n";
+    }
+    else std::cout << "ALT: No path found!\n";
+
+    // Pairwise distances between a few open cells along the diagonal
+    std::vector<std::pair<int, int>> points;
+    for (int i = 1; i < maze.getWidth() && i < maze.getHeight(); i += 6) points.push_back({ i, i });
+    auto matrix = landmarks.distanceMatrix(maze, points);
+
+    std::cout << "Distance matrix:\n";
+    for (const auto& row : matrix) {
+        for (int d : row) std::cout << std::setw(5) << d;
+        std::cout << "\n";
+    }
+}
+
+void demo::runJunctionGraphDemo() {
+    // Contract corridors and solve on the much smaller junction graph
+    std::cout << "\nJunction graph\n\n";
+    Maze maze(31, 31);
+    maze.generateMaze();
+    auto start = maze.getStart();
+    auto end = maze.getEnd();
+
+    JunctionGraph graph(maze);
+    int openCells = 0;
+    for (const auto& row : maze.getGrid()) openCells += static_cast<int>(std::count(row.begin(), row.end(), 1));
+    std::cout << "* Open cells: " << openCells << ", junctions and dead ends: " << graph.getNodeCount()
+        << ", corridors: " << graph.getEdgeCount() << "\n";
+
+    int expanded = 0;
+    auto path = graph.solve(maze, start.first, start.second, end.first, end.second, &expanded);
+    std::cout << "* Total path length: " << path.size() << " steps, nodes expanded: " << expanded << "\n";
+
+    // Knock out an inner wall between two corridors and update just that spot
+    for (int y = 1; y < maze.getHeight() - 1; y++) {
+        int x = (y % 2 == 0) ? 1 : 2;
+        if (maze.getGrid()[y][x] == 0) {
+            maze.setCell(x, y, 1);
+            graph.updateCell(maze, x, y);
+            std::cout << "Opened wall at (" << x << "," << y << ")\n";
+            break;
+        }
+    }
+
+    path = graph.solve(maze, start.first, start.second, end.first, end.second, &expanded);
+    std::cout << "* Total path length: " << path.size() << " steps, nodes expanded: " << expanded << "\n";
 }
\ No newline at end of file
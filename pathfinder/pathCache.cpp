@@ -0,0 +1,133 @@
+#include "pathCache.h"
+#include "bfs.h"
+#include "dijkstra.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+PathCache::PathCache(std::size_t capacity, Solver solver)
+    : capacity(capacity), solver(solver), hits(0), subpathHits(0), misses(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("PathCache: Capacity must be at least one entry");
+    }
+}
+
+// Remove one entry and forget its version once nothing refers to it any more
+std::list<PathCache::Entry>::iterator PathCache::erase(std::list<Entry>::iterator it) {
+    unsigned long long version = std::get<0>(it->key);
+    if (--versionEntries[version] == 0) {
+        versionEntries.erase(version);
+        auto seen = seenVersions.find(it->mazeId);
+        if (seen != seenVersions.end() && seen->second == version) seenVersions.erase(seen);
+    }
+    index.erase(it->key);
+    return entries.erase(it);
+}
+
+// Drop everything cached for an older version of this maze
+void PathCache::forgetStaleVersions(const Maze& maze) {
+    auto seen = seenVersions.find(maze.getId());
+    if (seen == seenVersions.end() || seen->second == maze.getVersion()) return;
+
+    unsigned long long stale = seen->second;
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (std::get<0>(it->key) == stale) it = erase(it);
+        else ++it;
+    }
+    seenVersions.erase(maze.getId());
+}
+
+// Look for a cached path that passes through both cells
+bool PathCache::findSubpath(unsigned long long version, int startCell, int endCell,
+    std::vector<std::pair<int, int>>& result) {
+
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (std::get<0>(it->key) != version) continue;
+
+        auto from = it->position.find(startCell);
+        if (from == it->position.end()) continue;
+        auto to = it->position.find(endCell);
+        if (to == it->position.end()) continue;
+
+        int first = std::min(from->second, to->second);
+        int last = std::max(from->second, to->second);
+        result.assign(it->path.begin() + first, it->path.begin() + last + 1);
+        // Paths are undirected, so walk it backwards if needed
+        if (from->second > to->second) std::reverse(result.begin(), result.end());
+
+        entries.splice(entries.begin(), entries, it);
+        return true;
+    }
+    return false;
+}
+
+void PathCache::insert(const Key& key, const std::vector<std::pair<int, int>>& path, const Maze& maze) {
+    entries.push_front(Entry());
+    Entry& entry = entries.front();
+    entry.key = key;
+    entry.mazeId = maze.getId();
+    entry.path = path;
+    // The solvers may start on a wall but never reach one, so a wall cell
+    // must not answer later queries as a subpath endpoint
+    const auto& grid = maze.getGrid();
+    int width = maze.getWidth();
+    for (int i = 0; i < static_cast<int>(path.size()); i++) {
+        if (grid[path[i].second][path[i].first] != 1) continue;
+        entry.position[path[i].second * width + path[i].first] = i;
+    }
+    index[key] = entries.begin();
+    versionEntries[std::get<0>(key)]++;
+    seenVersions[entry.mazeId] = std::get<0>(key);
+
+    // Evict the least recently used entry once we are over budget
+    if (entries.size() > capacity) erase(std::prev(entries.end()));
+}
+
+std::vector<std::pair<int, int>> PathCache::findPath(Maze& maze,
+    int startX, int startY, int endX, int endY) {
+
+    if (!maze.isValid(startX, startY) || !maze.isValid(endX, endY)) {
+        throw std::invalid_argument("PathCache: Start or end coordinates are outside maze boundaries");
+    }
+
+    forgetStaleVersions(maze);
+
+    int width = maze.getWidth();
+    Key key(maze.getVersion(), startY * width + startX, endY * width + endX);
+
+    // Exact hit, including remembered "no path" answers
+    auto found = index.find(key);
+    if (found != index.end()) {
+        hits++;
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->path;
+    }
+
+    std::vector<std::pair<int, int>> path;
+    if (findSubpath(std::get<0>(key), std::get<1>(key), std::get<2>(key), path)) {
+        hits++;
+        subpathHits++;
+        return path;
+    }
+
+    misses++;
+    if (solver == Solver::BFS) path = BFSSolver::solveBFS(maze, startX, startY, endX, endY);
+    else path = DijkstraSolver::solveDijkstra(maze, startX, startY, endX, endY);
+
+    insert(key, path, maze);
+    return path;
+}
+
+int PathCache::findDistance(Maze& maze, int startX, int startY, int endX, int endY) {
+    auto path = findPath(maze, startX, startY, endX, endY);
+    return path.empty() ? -1 : static_cast<int>(path.size()) - 1;
+}
+
+void PathCache::clear() {
+    entries.clear();
+    index.clear();
+    seenVersions.clear();
+    versionEntries.clear();
+}
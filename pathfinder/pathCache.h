@@ -0,0 +1,68 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include "maze.h"
+#include <vector>
+#include <utility>
+#include <list>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <cstddef>
+
+// Opt-in LRU cache of solved paths, keyed on maze version and endpoints.
+// Entries for a maze are dropped as soon as that maze is seen with a new
+// version. Every cached path is a shortest path, so it also answers
+// queries between any two of its own cells.
+class PathCache {
+public:
+    enum class Solver { BFS, Dijkstra };
+
+    // Every miss scans all cached paths for a subpath answer, so a miss
+    // costs O(capacity) on top of the search itself
+    explicit PathCache(std::size_t capacity = 64, Solver solver = Solver::BFS);
+
+    std::vector<std::pair<int, int>> findPath(Maze& maze,
+        int startX, int startY, int endX, int endY);
+    // Number of moves on the shortest path, or -1 when there is none
+    int findDistance(Maze& maze, int startX, int startY, int endX, int endY);
+
+    void clear();
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getSubpathHits() const { return subpathHits; }
+    std::size_t getMisses() const { return misses; }
+    std::size_t getSize() const { return entries.size(); }
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    using Key = std::tuple<unsigned long long, int, int>; // version, start cell, end cell
+
+    struct Entry {
+        Key key;
+        unsigned long long mazeId;
+        std::vector<std::pair<int, int>> path;
+        // Where each open cell sits on the path, for subpath lookups
+        std::unordered_map<int, int> position;
+    };
+
+    void forgetStaleVersions(const Maze& maze);
+    bool findSubpath(unsigned long long version, int startCell, int endCell,
+        std::vector<std::pair<int, int>>& result);
+    void insert(const Key& key, const std::vector<std::pair<int, int>>& path, const Maze& maze);
+    std::list<Entry>::iterator erase(std::list<Entry>::iterator it);
+
+    std::size_t capacity;
+    Solver solver;
+
+    std::list<Entry> entries; // most recently used first
+    std::map<Key, std::list<Entry>::iterator> index;
+    // Maze id -> version its entries belong to, and entries per version.
+    // Records go away with their last entry, so neither map outgrows the cache.
+    std::unordered_map<unsigned long long, unsigned long long> seenVersions;
+    std::unordered_map<unsigned long long, std::size_t> versionEntries;
+
+    std::size_t hits, subpathHits, misses;
+};
+
+#endif
@@ -0,0 +1,160 @@
+#include "steppedSearch.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <stdexcept>
+#include <chrono>
+
+SteppedSearch::SteppedSearch(const Maze& maze,
+    int startX, int startY, int endX, int endY, Algorithm algorithm)
+    : maze(maze), version(maze.getVersion()), grid(maze.getGrid()), width(maze.getWidth()), height(maze.getHeight()),
+    startCell(0), endCell(0), algorithm(algorithm), status(Status::Running),
+    expanded(0), discovered(0), openCells(0), bestCell(-1) {
+
+    if (!maze.isValid(startX, startY) || !maze.isValid(endX, endY)) {
+        throw std::invalid_argument("SteppedSearch: Start or end coordinates are outside maze boundaries");
+    }
+
+    startCell = startY * width + startX;
+    endCell = endY * width + endX;
+
+    distance.assign(width * height, INT_MAX);
+    parent.assign(width * height, -1);
+    closed.assign(width * height, false);
+
+    for (const auto& row : grid) {
+        openCells += static_cast<int>(std::count(row.begin(), row.end(), 1));
+    }
+
+    push(startCell, 0);
+}
+
+void SteppedSearch::push(int cell, int dist) {
+    if (distance[cell] == INT_MAX) discovered++;
+    distance[cell] = dist;
+    if (algorithm == Algorithm::BFS) queue.push(cell);
+    else heap.push(std::make_pair(dist, cell));
+}
+
+// Manhattan distance left to the end, used to rank partial paths
+int SteppedSearch::remainingTo(int cell) const {
+    return std::abs(cell % width - endCell % width) + std::abs(cell / width - endCell / width);
+}
+
+// Take one cell off the frontier and open up its neighbours
+void SteppedSearch::expandOne() {
+    int cell = -1;
+
+    if (algorithm == Algorithm::BFS) {
+        if (!queue.empty()) { cell = queue.front(); queue.pop(); }
+    }
+    else {
+        // Skip stale heap entries left behind by shorter routes
+        while (!heap.empty() && cell == -1) {
+            Node top = heap.top();
+            heap.pop();
+            if (!closed[top.second] && top.first == distance[top.second]) cell = top.second;
+        }
+    }
+
+    if (cell == -1) {
+        status = Status::NoPath;
+        return;
+    }
+
+    closed[cell] = true;
+    expanded++;
+
+    if (bestCell == -1 || remainingTo(cell) < remainingTo(bestCell)) bestCell = cell;
+
+    if (cell == endCell) {
+        status = Status::Found;
+        return;
+    }
+
+    const int dx[4] = { 0, 1, 0, -1 };
+    const int dy[4] = { -1, 0, 1, 0 };
+    int x = cell % width;
+    int y = cell / width;
+
+    for (int i = 0; i < 4; i++) {
+        int nx = x + dx[i];
+        int ny = y + dy[i];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height || grid[ny][nx] != 1) continue;
+
+        int next = ny * width + nx;
+        int newDist = distance[cell] + 1; // All moves cost the same in this maze
+        if (!closed[next] && newDist < distance[next]) {
+            parent[next] = cell;
+            push(next, newDist);
+        }
+    }
+}
+
+SteppedSearch::Status SteppedSearch::step(int nodeBudget) {
+    // Mixing cells from two different grids would give a meaningless path
+    if (status == Status::Running && maze.getVersion() != version) {
+        cancel();
+        throw std::runtime_error("SteppedSearch: Maze changed while the search was running");
+    }
+
+    for (int i = 0; i < nodeBudget && status == Status::Running; i++) {
+        expandOne();
+    }
+    return status;
+}
+
+SteppedSearch::Status SteppedSearch::stepFor(std::chrono::microseconds timeBudget) {
+    // Reading the clock costs more than expanding a cell, so check it in batches
+    const int batch = 64;
+    auto deadline = std::chrono::steady_clock::now() + timeBudget;
+
+    while (status == Status::Running) {
+        step(batch);
+        if (std::chrono::steady_clock::now() >= deadline) break;
+    }
+    return status;
+}
+
+void SteppedSearch::cancel() {
+    if (status != Status::Running) return;
+    status = Status::Cancelled;
+
+    // Give the frontier memory back right away
+    std::queue<int>().swap(queue);
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>>().swap(heap);
+}
+
+int SteppedSearch::getFrontierSize() const {
+    if (status == Status::Cancelled) return 0;
+    return discovered - expanded;
+}
+
+double SteppedSearch::getProgress() const {
+    if (status == Status::Found || status == Status::NoPath) return 1.0;
+    if (openCells == 0) return 0.0;
+    return std::min(1.0, static_cast<double>(expanded) / openCells);
+}
+
+// Walk backwards from a cell to the start using parent links
+std::vector<std::pair<int, int>> SteppedSearch::buildPath(int cell) const {
+    std::vector<std::pair<int, int>> path;
+    while (cell != -1) {
+        path.push_back({ cell % width, cell / width });
+        cell = parent[cell];
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<std::pair<int, int>> SteppedSearch::getPath() const {
+    if (status != Status::Found) return {};
+    return buildPath(endCell);
+}
+
+std::vector<std::pair<int, int>> SteppedSearch::getBestPartialPath() const {
+    if (bestCell == -1) return {};
+    return buildPath(bestCell);
+}
@@ -0,0 +1,74 @@
+#ifndef STEPPED_SEARCH_H
+#define STEPPED_SEARCH_H
+
+#include "maze.h"
+#include <vector>
+#include <utility>
+#include <queue>
+#include <functional>
+#include <chrono>
+
+// Resumable maze search that can be advanced a little at a time.
+// All search state lives inside the object, so several searches can run
+// side by side on the same maze. The maze must outlive the search; if it
+// changes while the search is running, the next step cancels the search
+// and throws.
+class SteppedSearch {
+public:
+    enum class Algorithm { BFS, Dijkstra };
+    enum class Status { Running, Found, NoPath, Cancelled };
+
+    SteppedSearch(const Maze& maze,
+        int startX, int startY, int endX, int endY,
+        Algorithm algorithm = Algorithm::BFS);
+
+    // Expand at most nodeBudget cells, then hand control back
+    Status step(int nodeBudget);
+    // Keep expanding until the time budget is spent or the search ends
+    Status stepFor(std::chrono::microseconds timeBudget);
+    void cancel();
+
+    Status getStatus() const { return status; }
+    bool isDone() const { return status != Status::Running; }
+    int getExpandedCount() const { return expanded; }
+    // Cells discovered but not yet expanded (stale heap entries are not counted)
+    int getFrontierSize() const;
+    // Share of open cells expanded so far, between 0 and 1
+    double getProgress() const;
+
+    // Full path once the search has found the end, empty otherwise
+    std::vector<std::pair<int, int>> getPath() const;
+    // Path to the expanded cell that got closest to the end so far
+    std::vector<std::pair<int, int>> getBestPartialPath() const;
+
+private:
+    using Node = std::pair<int, int>; // distance, cell index
+
+    void expandOne();
+    void push(int cell, int dist);
+    std::vector<std::pair<int, int>> buildPath(int cell) const;
+    int remainingTo(int cell) const;
+
+    const Maze& maze;
+    unsigned long long version;
+    const std::vector<std::vector<int>>& grid;
+    int width, height;
+    int startCell, endCell;
+    Algorithm algorithm;
+    Status status;
+
+    // Flat per-cell workspace indexed by y * width + x
+    std::vector<int> distance;
+    std::vector<int> parent;
+    std::vector<bool> closed;
+
+    std::queue<int> queue;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> heap;
+
+    int expanded;
+    int discovered;
+    int openCells;
+    int bestCell;
+};
+
+#endif